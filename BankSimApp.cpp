@@ -11,42 +11,182 @@
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <chrono>
+#include <thread>
 #include "EmptyDataCollectionException.h"
 #include "Event.h"
 #include "Queue.h"
 #include "BinaryHeap.h"
 #include "PriorityQueue.h"
+#include "BranchSimulation.h"
+#include "LindleySimulation.h"
+#include "SimulationServer.h"
+#include "ProcessSimulation.h"
+#include "IntervalReporter.h"
 
 using std::cin;
 using std::cout;
+using std::cerr;
 using std::endl;
 using std::getline;
 using std::string;
 using std::stoi;
 using std::setw;
+using std::strcmp;
+using std::vector;
+using std::chrono::steady_clock;
+using std::chrono::duration;
 
-void simulate();
+// Engine used for the single-teller simulation
+enum SimulationEngine { EVENT_ENGINE, FAST_ENGINE, PROCESS_ENGINE };
+
+void simulate(SimulationEngine engine, unsigned threads);
+void readArrivals(vector<int>& arrivals, vector<int>& transactions);
+bool checkEngines(unsigned threads);
+SimulationStats simulateEvents(const vector<int>& arrivals, const vector<int>& transactions,
+                               PriorityQueue<Event>* eventPriorityQueue, Queue<Event>* bankLine);
+bool simulateBranches(const BranchConfig& config, bool sequential);
 void processArrival(Event& anEvent, PriorityQueue<Event>* eventpq, Queue<Event>* bankq, bool& tp);
 double processDeparture(Event& anEvent, PriorityQueue<Event>* eventpq, Queue<Event>* bankq, bool& tp);
 
-int main() {
-    simulate();
+// Print a line per processed event (turned off when comparing engines)
+static bool traceEvents = true;
+
+// Periodic interval reports from the event loop (none when null)
+static IntervalReporter* intervalReporter = nullptr;
+
+// Description: Parses the value of a numeric option into value.
+//              Returns false (leaving value unchanged) if text is not a
+//              whole number in the range of int.
+static bool parseNumber(const char* text, int& value) {
+    size_t used = 0;
+    int parsed = 0;
+    try {parsed = stoi(text, &used);}
+    catch (std::invalid_argument& anException) {return false;}
+    catch (std::out_of_range& anException) {return false;}
+    if (text[used] != '\0') return false;
+    value = parsed;
+    return true;
+}
+
+// Description: Parses the value of a count option into value.
+//              Returns false (leaving value unchanged) if it is not a
+//              number or is negative.
+static bool parseCount(const char* text, unsigned& value) {
+    int parsed;
+    if (!parseNumber(text, parsed) || parsed < 0) return false;
+    value = parsed;
+    return true;
+}
+
+// Usage: BankSimApp [--fast | --process | --check] [--threads n] < datafile
+//        BankSimApp [--report-every t] [--report-wall ms] < datafile
+//        BankSimApp --serve socketpath [--threads n]      (workers default to one per core)
+//        BankSimApp --branches n [--threads n] [--balk n] [--walk t] [--sequential] < datafile
+//        Without --branches the single-teller simulation is run.
+int main(int argc, char* argv[]) {
+    BranchConfig config;
+    bool branchMode = false;
+    bool sequential = false;
+    SimulationEngine engine = EVENT_ENGINE;
+    bool check = false;
+    int reportEvery = 0;
+    int reportWall = 0;
+    const char* socketPath = nullptr;
+    bool threadsGiven = false;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        bool validValue = true;
+        if (strcmp(argv[i], "--branches") == 0 && hasValue) {
+            validValue = parseCount(argv[++i], config.branches);
+            branchMode = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+            validValue = parseCount(argv[++i], config.threads);
+            threadsGiven = true;
+        } else if (strcmp(argv[i], "--balk") == 0 && hasValue) {
+            validValue = parseCount(argv[++i], config.balkLength);
+        } else if (strcmp(argv[i], "--walk") == 0 && hasValue) {
+            validValue = parseNumber(argv[++i], config.walkTime);
+        } else if (strcmp(argv[i], "--sequential") == 0) {
+            sequential = true;
+        } else if (strcmp(argv[i], "--fast") == 0) {
+            engine = FAST_ENGINE;
+        } else if (strcmp(argv[i], "--process") == 0) {
+            engine = PROCESS_ENGINE;
+        } else if (strcmp(argv[i], "--check") == 0) {
+            check = true;
+        } else if (strcmp(argv[i], "--serve") == 0 && hasValue) {
+            socketPath = argv[++i];
+        } else if (strcmp(argv[i], "--report-every") == 0 && hasValue) {
+            validValue = parseNumber(argv[++i], reportEvery);
+        } else if (strcmp(argv[i], "--report-wall") == 0 && hasValue) {
+            validValue = parseNumber(argv[++i], reportWall);
+        } else {
+            cout << "Unknown or incomplete option: " << argv[i] << endl;
+            return 1;
+        }
+        if (!validValue) {
+            cout << "Invalid value for " << argv[i - 1] << ": " << argv[i] << endl;
+            return 1;
+        }
+    }
+    if (config.branches < 1 || config.threads < 1 || config.walkTime < 1) {
+        cout << "--branches and --threads must be at least 1, --walk at least 1" << endl;
+        return 1;
+    }
+    if (reportEvery < 0 || reportWall < 0) {
+        cout << "--report-every and --report-wall must not be negative" << endl;
+        return 1;
+    }
+    // Interval reports come from the event loop only
+    bool reporting = reportEvery > 0 || reportWall > 0;
+    if (reporting && (engine != EVENT_ENGINE || check || branchMode || socketPath)) {
+        cout << "--report-every and --report-wall cannot be combined with "
+             << "--fast, --process, --check, --branches or --serve" << endl;
+        return 1;
+    }
+
+    if (socketPath) {
+        traceEvents = false;
+        // One worker per core unless told otherwise
+        unsigned workers = config.threads;
+        if (!threadsGiven && std::thread::hardware_concurrency() > 0) workers = std::thread::hardware_concurrency();
+        return serveSimulations(socketPath, workers, simulateEvents) ? 0 : 1;
+    }
+    if (branchMode) return simulateBranches(config, sequential) ? 0 : 1;
+    else if (check) return checkEngines(config.threads) ? 0 : 1;
+    else if (reporting) {
+        // Reports go to stderr so the simulation output is unchanged
+        intervalReporter = new IntervalReporter(reportEvery, reportWall, cerr);
+        simulate(engine, config.threads);
+        delete intervalReporter;
+        intervalReporter = nullptr;
+    }
+    else simulate(engine, config.threads);
     return 0;
 }
 
-// Description: Performs the simulation
-void simulate() {
-    cout << "Simulation Begins" << endl;
-    int peopleprocessed = 0;
-    double totalwaittime = 0;
-    // bankLine = a new empty queue // Bank line
-    Queue<Event>* bankLine = new Queue<Event>();
-    // eventPriorityQueue = a new empty priority queue // Event queue
-    PriorityQueue<Event>* eventPriorityQueue = new PriorityQueue<Event>();
-    // tellerAvailable = true
-    bool teller = true;
-    int currentTime = 0;
+// Description: Performs the multi-branch simulation
+//              Returns false if the datafile is invalid.
+bool simulateBranches(const BranchConfig& config, bool sequential) {
+    cout << "Simulation Begins (" << config.branches << " branches";
+    if (!sequential) cout << ", " << config.threads << " threads";
+    cout << ")" << endl;
+    vector<BranchEvent> arrivals;
+    if (!readBranchArrivals(cin, config, arrivals)) return false;
+    vector<BranchStats> stats;
+    if (sequential) stats = simulateBranchesSequential(arrivals, config);
+    else stats = simulateBranchesParallel(arrivals, config);
+    cout << "Simulation Ends" << endl << endl;
+    printBranchStatistics(stats);
+    return true;
+}
 
+// Description: Reads "arrival transaction" lines from the datafile
+void readArrivals(vector<int>& arrivals, vector<int>& transactions) {
     string line;
     string arrivaltime;
     string transactiontime;
@@ -54,7 +194,6 @@ void simulate() {
     size_t pos = 0;
     unsigned int a;
     unsigned int t;
-    //Create and add arrival events to event queue
     // while(datafile is not empty)
     while (getline(cin,line)) 
     {
@@ -65,13 +204,116 @@ void simulate() {
         transactiontime = line;
         a = stoi(arrivaltime);
         t = stoi(transactiontime);
+        arrivals.push_back(a);
+        transactions.push_back(t);
+    }
+}
+
+// Description: Performs the simulation
+//              With FAST_ENGINE, traces with non-decreasing arrival times skip
+//              the event loop and use the Lindley recursion instead.
+//              With PROCESS_ENGINE, customers run as coroutines and only the
+//              final statistics are printed.
+//              Interval reports are only produced by the event loop.
+void simulate(SimulationEngine engine, unsigned threads) {
+    cout << "Simulation Begins" << endl;
+    vector<int> arrivals;
+    vector<int> transactions;
+    readArrivals(arrivals, transactions);
+    SimulationStats stats;
+    if (engine == FAST_ENGINE && qualifiesForLindley(arrivals)) {
+        stats = simulateLindley(arrivals, transactions, threads);
+    } else if (engine == PROCESS_ENGINE) {
+        stats = simulateProcesses(arrivals, transactions);
+    } else {
+        // bankLine = a new empty queue // Bank line
+        Queue<Event>* bankLine = new Queue<Event>();
+        // eventPriorityQueue = a new empty priority queue // Event queue
+        PriorityQueue<Event>* eventPriorityQueue = new PriorityQueue<Event>();
+        stats = simulateEvents(arrivals, transactions, eventPriorityQueue, bankLine);
+        delete bankLine;
+        delete eventPriorityQueue;
+    }
+    cout << "Simulation Ends" << endl << endl;
+    cout << "Final Statistics:" << endl << endl;
+    cout << "\tTotal number of people processed: " << stats.peopleprocessed << endl;
+    double avgwaittime = stats.totalwaittime / stats.peopleprocessed;
+    cout << "\tAverage amount of time spent waiting: " << avgwaittime << endl << endl;
+}
+
+// Description: Runs the event-driven engine, the coroutine process engine and
+//              (if the trace qualifies) the Lindley fast path on the same trace
+//              and reports whether their statistics agree, with the events/sec
+//              of each loop.
+//              Returns true if they do.
+bool checkEngines(unsigned threads) {
+    vector<int> arrivals;
+    vector<int> transactions;
+    readArrivals(arrivals, transactions);
+    traceEvents = false;
+    // Each customer is one arrival and one departure
+    double events = 2.0 * arrivals.size();
+
+    PriorityQueue<Event> eventPriorityQueue;
+    Queue<Event> bankLine;
+    steady_clock::time_point started = steady_clock::now();
+    SimulationStats expected = simulateEvents(arrivals, transactions, &eventPriorityQueue, &bankLine);
+    duration<double> eventSeconds = steady_clock::now() - started;
+
+    started = steady_clock::now();
+    SimulationStats processes = simulateProcesses(arrivals, transactions);
+    duration<double> processSeconds = steady_clock::now() - started;
+
+    // The fast path is skipped when the trace does not qualify for it
+    bool fastPath = qualifiesForLindley(arrivals);
+    SimulationStats fast = expected;
+    if (fastPath) fast = simulateLindley(arrivals, transactions, threads);
+
+    cout << "Event engine:   " << expected.peopleprocessed << " people, total wait " << expected.totalwaittime
+         << ", " << events / eventSeconds.count() << " events/sec" << endl;
+    cout << "Process engine: " << processes.peopleprocessed << " people, total wait " << processes.totalwaittime
+         << ", " << events / processSeconds.count() << " events/sec" << endl;
+    if (fastPath) {
+        cout << "Fast path:      " << fast.peopleprocessed << " people, total wait " << fast.totalwaittime << endl;
+    } else {
+        cout << "Fast path:      skipped (arrival times decrease)" << endl;
+    }
+    bool same = expected.peopleprocessed == processes.peopleprocessed
+             && expected.totalwaittime == processes.totalwaittime
+             && expected.peopleprocessed == fast.peopleprocessed
+             && expected.totalwaittime == fast.totalwaittime;
+    cout << (same ? "All engines match" : "Engines DIFFER") << endl;
+    return same;
+}
+
+// Description: Event-driven single-teller simulation
+// Precondition: eventPriorityQueue and bankLine are empty.
+// Postcondition: eventPriorityQueue and bankLine are empty again, so callers
+//                can reuse them for the next trace. The PriorityQueue keeps its
+//                capacity; the Queue only does with shrinking turned off.
+SimulationStats simulateEvents(const vector<int>& arrivals, const vector<int>& transactions,
+                               PriorityQueue<Event>* eventPriorityQueue, Queue<Event>* bankLine) {
+    SimulationStats stats;
+    // tellerAvailable = true
+    bool teller = true;
+    int currentTime = 0;
+
+    // Arrival events are added to the event queue one at a time, in arrival
+    // order, so customers arriving at the same time are served in input order
+    // and the event queue never holds more than one arrival.
+    vector<size_t> order = arrivalOrder(arrivals);
+    size_t nextArrival = 0;
+    if (nextArrival < order.size()) {
         // newArrivalEvent = a new arrival event containing a and t
-        Event newArrivalEvent = Event('A',a,t);
+        Event newArrivalEvent = Event('A',arrivals[order[nextArrival]],transactions[order[nextArrival]]);
+        nextArrival++;
         // eventPriorityQueue.enqueue(newArrivalEvent)
-        try {eventPriorityQueue->enqueue(newArrivalEvent);}
-        catch (EmptyDataCollectionException& anException) {}
+        eventPriorityQueue->enqueue(newArrivalEvent);
     }
 
+    // The first report window starts at the first event
+    if (intervalReporter && !order.empty()) intervalReporter->begin(arrivals[order[0]]);
+
     //Event loop
     // while(eventPriorityQueue is not empty)
     while (!eventPriorityQueue->isEmpty()) {
@@ -83,22 +325,29 @@ void simulate() {
         // currentTime = time of newEvent
         currentTime = newEvent.getTime();
         double waittime = 0;
+        if (intervalReporter && intervalReporter->due(currentTime)) {
+            intervalReporter->report(currentTime, bankLine->getElementCount(), eventPriorityQueue->getElementCount());
+        }
         // if (newEvent is an arrival event)
         if (newEvent.isArrival()) {
             processArrival(newEvent,eventPriorityQueue,bankLine,teller);
+            if (nextArrival < order.size()) {
+                Event newArrivalEvent = Event('A',arrivals[order[nextArrival]],transactions[order[nextArrival]]);
+                nextArrival++;
+                eventPriorityQueue->enqueue(newArrivalEvent);
+            }
         } else {
             waittime = processDeparture(newEvent,eventPriorityQueue,bankLine,teller);
-            peopleprocessed++;
-            totalwaittime += waittime;
+            stats.peopleprocessed++;
+            stats.totalwaittime += waittime;
+            if (intervalReporter) intervalReporter->recordDeparture(waittime);
         }
+        if (intervalReporter) intervalReporter->recordEvent();
     }
-    delete bankLine;
-    delete eventPriorityQueue;
-    cout << "Simulation Ends" << endl << endl;
-    cout << "Final Statistics:" << endl << endl;
-    cout << "\tTotal number of people processed: " << peopleprocessed << endl;
-    double avgwaittime = totalwaittime / peopleprocessed;
-    cout << "\tAverage amount of time spent waiting: " << avgwaittime << endl << endl;
+    if (intervalReporter) {
+        intervalReporter->finish(currentTime, bankLine->getElementCount(), eventPriorityQueue->getElementCount());
+    }
+    return stats;
 }
 
 //Processes an arrival event
@@ -107,7 +356,7 @@ void processArrival(Event& arrivalEvent, PriorityQueue<Event>* eventpq, Queue<Ev
     //Remove this event from the event queue
     // eventPriorityQueue.dequeue()
     int currentTime = arrivalEvent.getTime();
-    cout << "Processing an arrival event at time:" << setw(6) << currentTime << endl;
+    if (traceEvents) cout << "Processing an arrival event at time:" << setw(6) << currentTime << endl;
     try {eventpq->dequeue();}
     catch (EmptyDataCollectionException& anException) {}
     // customer = customer referenced in arrivalEvent
@@ -130,7 +379,7 @@ void processArrival(Event& arrivalEvent, PriorityQueue<Event>* eventpq, Queue<Ev
 double processDeparture(Event& departureEvent, PriorityQueue<Event>* eventpq, Queue<Event>* bankq, bool& teller) {
     //Remove this event from the event queue
     int currentTime = departureEvent.getTime();
-    cout << "Processing a departure event at time:" << setw(5) << currentTime << endl;
+    if (traceEvents) cout << "Processing a departure event at time:" << setw(5) << currentTime << endl;
     try {eventpq->dequeue();}
     catch (EmptyDataCollectionException& anException) {}
     int waittime = 0;
@@ -0,0 +1,291 @@
+/*
+ * BranchSimulation.cpp
+ *
+ * Description: Multi-branch Bank Simulation where customers who see a long
+ *              line walk to the neighbouring branch. Branches can be simulated
+ *              sequentially (one event PriorityQueue) or in parallel (branches
+ *              partitioned across threads, synchronised by conservative
+ *              lookahead equal to the walking time between branches).
+ *
+ * Author:
+ * Date:    November 17, 2023
+ *
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <barrier>
+#include <climits>
+#include "EmptyDataCollectionException.h"
+#include "Queue.h"
+#include "PriorityQueue.h"
+#include "BranchSimulation.h"
+
+using std::cout;
+using std::endl;
+using std::getline;
+using std::istream;
+using std::istringstream;
+using std::string;
+using std::setw;
+using std::vector;
+
+// Description: Default constructor
+BranchEvent::BranchEvent() :
+    type('A'), time(0), length(0), branch(0), customer(0), transferred(false) {
+}
+
+// Description: Constructor
+BranchEvent::BranchEvent(char type, int time, int length, unsigned branch, unsigned customer) :
+    type(type), time(time), length(length), branch(branch), customer(customer), transferred(false) {
+}
+
+// Description: Returns true if this is an arrival event.
+bool BranchEvent::isArrival() const {
+    return type == 'A';
+}
+
+// Description: Total order on events: time, then departures before arrivals
+//              (the teller frees up first), then branch, then customer.
+bool BranchEvent::operator<=(const BranchEvent& rhs) const {
+    if (time != rhs.time) return time < rhs.time;
+    if (type != rhs.type) return type == 'D';
+    if (branch != rhs.branch) return branch < rhs.branch;
+    return customer <= rhs.customer;
+}
+
+// Description: Prints the event.
+void BranchEvent::print() const {
+    cout << type << " " << time << " " << length << " @" << branch;
+}
+
+BranchStats::BranchStats() :
+    peopleprocessed(0), totalwaittime(0), transfersOut(0), transfersIn(0) {
+}
+
+BranchConfig::BranchConfig() :
+    branches(1), threads(1), balkLength(3), walkTime(1) {
+}
+
+// State of a single branch: its line, its teller and its statistics.
+struct BranchState {
+    Queue<BranchEvent> bankLine;
+    unsigned lineLength = 0;
+    bool teller = true;
+    BranchStats stats;
+};
+
+// Description: Applies anEvent to its branch.
+// Postcondition: Events caused by anEvent (a departure at the same branch or
+//                an arrival at the neighbouring branch) are appended to produced.
+static void processBranchEvent(BranchState& state, const BranchEvent& anEvent,
+                               const BranchConfig& config, vector<BranchEvent>& produced) {
+    int currentTime = anEvent.time;
+    if (anEvent.isArrival()) {
+        if (anEvent.transferred) state.stats.transfersIn++;
+        // Customer sees a long line and walks to the next branch (only once)
+        if (config.branches > 1 && !anEvent.transferred && state.lineLength >= config.balkLength) {
+            BranchEvent walked = anEvent;
+            walked.time = currentTime + config.walkTime;
+            walked.branch = (anEvent.branch + 1) % config.branches;
+            walked.transferred = true;
+            produced.push_back(walked);
+            state.stats.transfersOut++;
+            return;
+        }
+        if (state.lineLength == 0 && state.teller) {
+            produced.push_back(BranchEvent('D', currentTime + anEvent.length, 0, anEvent.branch, anEvent.customer));
+            state.teller = false;
+        } else {
+            BranchEvent customer = anEvent;
+            state.bankLine.enqueue(customer);
+            state.lineLength++;
+        }
+    } else {
+        int waittime = 0;
+        if (state.lineLength > 0) {
+            // Customer at front of line begins transaction
+            BranchEvent customer;
+            try {customer = state.bankLine.peek();}
+            catch (EmptyDataCollectionException& anException) {}
+            try {state.bankLine.dequeue();}
+            catch (EmptyDataCollectionException& anException) {}
+            state.lineLength--;
+            produced.push_back(BranchEvent('D', currentTime + customer.length, 0, customer.branch, customer.customer));
+            waittime = currentTime - customer.time;
+        } else {
+            state.teller = true;
+        }
+        state.stats.peopleprocessed++;
+        state.stats.totalwaittime += waittime;
+    }
+}
+
+// Description: Reads "arrival transaction [branch]" lines from in.
+//              Lines without a branch are assigned round-robin.
+//              Returns false if a line names a branch that does not exist.
+bool readBranchArrivals(istream& in, const BranchConfig& config, vector<BranchEvent>& arrivals) {
+    string line;
+    unsigned customer = 0;
+    while (getline(in, line)) {
+        istringstream fields(line);
+        int a = 0;
+        int t = 0;
+        if (!(fields >> a >> t)) continue;
+        long b = 0;
+        if (fields >> b) {
+            if (b < 0 || b >= (long)config.branches) {
+                cout << "Branch " << b << " out of range 0.." << config.branches - 1
+                     << " for customer " << customer << ": " << line << endl;
+                return false;
+            }
+        } else {
+            b = customer % config.branches;
+        }
+        arrivals.push_back(BranchEvent('A', a, t, (unsigned)b, customer));
+        customer++;
+    }
+    return true;
+}
+
+// Description: Simulates all branches with a single event PriorityQueue.
+std::vector<BranchStats> simulateBranchesSequential(const vector<BranchEvent>& arrivals, const BranchConfig& config) {
+    vector<BranchState> branches(config.branches);
+    PriorityQueue<BranchEvent> eventPriorityQueue;
+    for (BranchEvent arrival : arrivals) {
+        eventPriorityQueue.enqueue(arrival);
+    }
+
+    vector<BranchEvent> produced;
+    while (!eventPriorityQueue.isEmpty()) {
+        BranchEvent newEvent;
+        try {newEvent = eventPriorityQueue.peek();}
+        catch (EmptyDataCollectionException& anException) {}
+        try {eventPriorityQueue.dequeue();}
+        catch (EmptyDataCollectionException& anException) {}
+
+        produced.clear();
+        processBranchEvent(branches[newEvent.branch], newEvent, config, produced);
+        for (BranchEvent& next : produced) {
+            eventPriorityQueue.enqueue(next);
+        }
+    }
+
+    vector<BranchStats> stats;
+    for (BranchState& branch : branches) {
+        stats.push_back(branch.stats);
+    }
+    return stats;
+}
+
+// A branch owned by one worker thread in the parallel engine.
+struct BranchPartition {
+    BranchState state;
+    PriorityQueue<BranchEvent> events;
+    vector<BranchEvent> outbox;     // transfers produced during the current window
+};
+
+// Description: Simulates the branches on config.threads threads.
+std::vector<BranchStats> simulateBranchesParallel(const vector<BranchEvent>& arrivals, const BranchConfig& config) {
+    vector<BranchPartition> branches(config.branches);
+    for (BranchEvent arrival : arrivals) {
+        branches[arrival.branch].events.enqueue(arrival);
+    }
+
+    unsigned threadCount = config.threads;
+    if (threadCount > config.branches) threadCount = config.branches;
+    if (threadCount == 0) threadCount = 1;
+
+    // Global virtual time: earliest pending event over all branches.
+    // Returns false when every branch has run out of events.
+    auto nextWindow = [&branches](int& gvt) {
+        bool found = false;
+        gvt = INT_MAX;
+        for (BranchPartition& branch : branches) {
+            if (!branch.events.isEmpty() && branch.events.peek().time < gvt) {
+                gvt = branch.events.peek().time;
+                found = true;
+            }
+        }
+        return found;
+    };
+
+    int gvt = 0;
+    bool done = !nextWindow(gvt);
+    int windowEnd = gvt + config.walkTime;
+
+    // Runs once per window after every worker has finished it:
+    // deliver transfers and open the next window.
+    auto endOfWindow = [&]() noexcept {
+        for (BranchPartition& branch : branches) {
+            for (BranchEvent& transfer : branch.outbox) {
+                branches[transfer.branch].events.enqueue(transfer);
+            }
+            branch.outbox.clear();
+        }
+        done = !nextWindow(gvt);
+        windowEnd = gvt + config.walkTime;
+    };
+    std::barrier windowBarrier(threadCount, endOfWindow);
+
+    auto worker = [&](unsigned id) {
+        vector<BranchEvent> produced;
+        while (!done) {
+            for (unsigned b = id; b < branches.size(); b += threadCount) {
+                BranchPartition& branch = branches[b];
+                while (!branch.events.isEmpty() && branch.events.peek().time < windowEnd) {
+                    BranchEvent newEvent = branch.events.peek();
+                    branch.events.dequeue();
+
+                    produced.clear();
+                    processBranchEvent(branch.state, newEvent, config, produced);
+                    for (BranchEvent& next : produced) {
+                        // Transfers land at or after windowEnd, so they can wait for the barrier
+                        if (next.branch == b) branch.events.enqueue(next);
+                        else branch.outbox.push_back(next);
+                    }
+                }
+            }
+            windowBarrier.arrive_and_wait();
+        }
+    };
+
+    vector<std::thread> workers;
+    for (unsigned id = 1; id < threadCount; id++) {
+        workers.emplace_back(worker, id);
+    }
+    worker(0);
+    for (std::thread& w : workers) {
+        w.join();
+    }
+
+    vector<BranchStats> stats;
+    for (BranchPartition& branch : branches) {
+        stats.push_back(branch.state.stats);
+    }
+    return stats;
+}
+
+// Description: Prints per-branch and overall statistics.
+void printBranchStatistics(const vector<BranchStats>& stats) {
+    int peopleprocessed = 0;
+    double totalwaittime = 0;
+    cout << "Final Statistics:" << endl << endl;
+    for (unsigned b = 0; b < stats.size(); b++) {
+        const BranchStats& branch = stats[b];
+        double avgwaittime = branch.peopleprocessed ? branch.totalwaittime / branch.peopleprocessed : 0;
+        cout << "\tBranch " << setw(3) << b << ": processed " << setw(9) << branch.peopleprocessed
+             << ", average wait " << setw(10) << avgwaittime
+             << ", walked out " << setw(9) << branch.transfersOut
+             << ", walked in " << setw(9) << branch.transfersIn << endl;
+        peopleprocessed += branch.peopleprocessed;
+        totalwaittime += branch.totalwaittime;
+    }
+    cout << endl;
+    cout << "\tTotal number of people processed: " << peopleprocessed << endl;
+    double avgwaittime = totalwaittime / peopleprocessed;
+    cout << "\tAverage amount of time spent waiting: " << avgwaittime << endl << endl;
+}
@@ -0,0 +1,82 @@
+/*
+ * BranchSimulation.h
+ *
+ * Description: Multi-branch Bank Simulation where customers who see a long
+ *              line walk to the neighbouring branch. Branches can be simulated
+ *              sequentially (one event PriorityQueue) or in parallel (branches
+ *              partitioned across threads, synchronised by conservative
+ *              lookahead equal to the walking time between branches).
+ *
+ * Author:
+ * Date:    November 17, 2023
+ *
+ */
+
+#ifndef BRANCHSIMULATION_H
+#define BRANCHSIMULATION_H
+
+#include <istream>
+#include <vector>
+
+// Description: Event exchanged between branches.
+//              Events are totally ordered by (time, departures first, branch, customer)
+//              so a branch sees the same event sequence regardless of how
+//              the simulation is partitioned.
+struct BranchEvent {
+    char type;              // 'A' = arrival, 'D' = departure
+    int time;
+    int length;             // transaction time
+    unsigned branch;        // branch the event happens at
+    unsigned customer;      // input line number of the customer
+    bool transferred;       // true once the customer has walked to another branch
+
+    BranchEvent();
+    BranchEvent(char type, int time, int length, unsigned branch, unsigned customer);
+
+    bool isArrival() const;
+    bool operator<=(const BranchEvent& rhs) const;
+    void print() const;
+};
+
+// Description: Statistics accumulated by one branch.
+struct BranchStats {
+    int peopleprocessed;
+    double totalwaittime;
+    int transfersOut;
+    int transfersIn;
+
+    BranchStats();
+};
+
+// Description: Parameters of a multi-branch run.
+struct BranchConfig {
+    unsigned branches;      // number of branches (>= 1)
+    unsigned threads;       // worker threads for the parallel engine (>= 1)
+    unsigned balkLength;    // a customer finding this many people in line walks away
+    int walkTime;           // time to walk to the neighbouring branch (>= 1), also the lookahead
+
+    BranchConfig();
+};
+
+// Description: Reads "arrival transaction [branch]" lines from in.
+//              Lines without a branch are assigned round-robin.
+//              Returns false (after printing the offending line) if a line names
+//              a branch outside 0 .. config.branches - 1.
+// Postcondition: arrivals holds one arrival event per input line.
+bool readBranchArrivals(std::istream& in, const BranchConfig& config, std::vector<BranchEvent>& arrivals);
+
+// Description: Simulates all branches with a single event PriorityQueue.
+// Time Efficiency: O(n log2 n)
+std::vector<BranchStats> simulateBranchesSequential(const std::vector<BranchEvent>& arrivals, const BranchConfig& config);
+
+// Description: Simulates the branches on config.threads threads.
+//              Each thread processes its branches' events inside a window
+//              [GVT, GVT + walkTime); transfers produced in a window can only
+//              land in a later one and are delivered at the window barrier.
+// Postcondition: Returns exactly what simulateBranchesSequential() returns.
+std::vector<BranchStats> simulateBranchesParallel(const std::vector<BranchEvent>& arrivals, const BranchConfig& config);
+
+// Description: Prints per-branch and overall statistics.
+void printBranchStatistics(const std::vector<BranchStats>& stats);
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * IntervalReporter.cpp
+ *
+ * Description: Periodic progress reports for long simulation runs.
+ *              The event loop feeds per-window accumulators (reset at every
+ *              report) and hands each finished report to a writer thread
+ *              through a fixed-size ring, so it never waits on output.
+ *
+ * Author:
+ * Date:    November 17, 2023
+ *
+ */
+
+#include <iostream>
+#include <iomanip>
+#include "IntervalReporter.h"
+
+using std::endl;
+using std::setw;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using std::chrono::milliseconds;
+
+// Description: Constructor
+IntervalReporter::IntervalReporter(int simInterval, int wallMillis, std::ostream& out) :
+    simInterval(simInterval),
+    wallInterval(milliseconds(wallMillis)),
+    out(out),
+    nextBoundary(simInterval),
+    head(0),
+    tail(0),
+    dropped(0),
+    finished(false) {
+    resetWindow(0);
+    writer = std::thread(&IntervalReporter::writeReports, this);
+}
+
+// Description: Destructor
+// Postcondition: Every published report has been written.
+IntervalReporter::~IntervalReporter() {
+    finished.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wake.notify_one();
+    writer.join();
+}
+
+// Utility method
+// Description: Starts a new window at windowStart with empty accumulators.
+void IntervalReporter::resetWindow(int windowStart) {
+    current.windowStart = windowStart;
+    current.windowEnd = windowStart;
+    current.served = 0;
+    current.totalwaittime = 0;
+    current.maxwaittime = 0;
+    current.lineLength = 0;
+    current.heapSize = 0;
+    current.events = 0;
+    current.wallSeconds = 0;
+    windowStarted = steady_clock::now();
+}
+
+// Description: Starts the first window at startTime, clearing anything
+//              counted so far.
+void IntervalReporter::begin(int startTime) {
+    nextBoundary = simInterval > 0 ? startTime + simInterval : 0;
+    resetWindow(startTime);
+}
+
+// Utility method
+// Description: Hands report to the writer thread. If the writer has fallen a
+//              full ring behind, the report is dropped rather than waiting.
+void IntervalReporter::publish(const IntervalReport& report) {
+    unsigned long slot = head.load(std::memory_order_relaxed);
+    if (slot - tail.load(std::memory_order_acquire) == RING_CAPACITY) {
+        dropped++;
+        return;
+    }
+    ring[slot % RING_CAPACITY] = report;
+    head.store(slot + 1, std::memory_order_release);
+    wake.notify_one();
+}
+
+// Description: Closes the current window at currentTime (rounded down to
+//              a report boundary in simulated-time mode) and publishes it.
+void IntervalReporter::report(int currentTime, unsigned lineLength, unsigned heapSize) {
+    int windowEnd = currentTime;
+    if (simInterval > 0 && currentTime >= nextBoundary) {
+        // Windows without events are folded into this one
+        windowEnd = nextBoundary + (currentTime - nextBoundary) / simInterval * simInterval;
+        nextBoundary = windowEnd + simInterval;
+    }
+    current.windowEnd = windowEnd;
+    current.lineLength = lineLength;
+    current.heapSize = heapSize;
+    current.wallSeconds = duration<double>(steady_clock::now() - windowStarted).count();
+    publish(current);
+    resetWindow(windowEnd);
+}
+
+// Description: Publishes the last, partial window, which includes events at endTime.
+void IntervalReporter::finish(int endTime, unsigned lineLength, unsigned heapSize) {
+    if (current.events == 0) return;
+    current.windowEnd = endTime + 1;
+    current.lineLength = lineLength;
+    current.heapSize = heapSize;
+    current.wallSeconds = duration<double>(steady_clock::now() - windowStarted).count();
+    publish(current);
+    resetWindow(endTime + 1);
+}
+
+// Utility method
+// Description: Writer thread: writes reports as they are published until
+//              the reporter is destroyed and the ring is drained.
+void IntervalReporter::writeReports() {
+    while (true) {
+        unsigned long slot = tail.load(std::memory_order_relaxed);
+        if (slot == head.load(std::memory_order_acquire)) {
+            if (finished.load(std::memory_order_acquire) && slot == head.load(std::memory_order_acquire)) break;
+            // Timed wait: publish() notifies without taking the lock
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait_for(lock, milliseconds(10));
+            continue;
+        }
+        IntervalReport report = ring[slot % RING_CAPACITY];
+        tail.store(slot + 1, std::memory_order_release);
+
+        double meanwait = report.served ? report.totalwaittime / report.served : 0;
+        double eventsPerSecond = report.wallSeconds > 0 ? report.events / report.wallSeconds : 0;
+        out << "Interval [" << setw(8) << report.windowStart << "," << setw(8) << report.windowEnd << "):"
+            << " served" << setw(7) << report.served
+            << ", mean wait" << setw(10) << meanwait
+            << ", max wait" << setw(7) << report.maxwaittime
+            << ", line" << setw(6) << report.lineLength
+            << ", heap" << setw(8) << report.heapSize
+            << ", events/sec" << setw(12) << eventsPerSecond << endl;
+    }
+    if (dropped > 0) {
+        out << "Interval reports dropped (writer fell behind): " << dropped << endl;
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * IntervalReporter.h
+ *
+ * Description: Periodic progress reports for long simulation runs.
+ *              The event loop feeds per-window accumulators (reset at every
+ *              report) and hands each finished report to a writer thread
+ *              through a fixed-size ring, so it never waits on output.
+ *
+ * Author:
+ * Date:    November 17, 2023
+ *
+ */
+
+#ifndef INTERVALREPORTER_H
+#define INTERVALREPORTER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+// Description: Statistics of one reporting window [windowStart, windowEnd).
+struct IntervalReport {
+    int windowStart;
+    int windowEnd;
+    int served;
+    double totalwaittime;
+    int maxwaittime;
+    unsigned lineLength;        // bank line length when the report was taken
+    unsigned heapSize;          // pending events when the report was taken
+    unsigned long events;
+    double wallSeconds;
+};
+
+class IntervalReporter {
+    private:
+        static const unsigned RING_CAPACITY = 64;
+        // Only check the wall clock every this many events.
+        static const unsigned long WALL_CHECK_EVENTS = 1024;
+
+        int simInterval;                    // 0 = no simulated-time reports
+        std::chrono::steady_clock::duration wallInterval;   // zero = no wall-time reports
+        std::ostream& out;
+
+        // Accumulators of the current window, owned by the event loop
+        IntervalReport current;
+        int nextBoundary;
+        std::chrono::steady_clock::time_point windowStarted;
+
+        // Single-producer single-consumer ring of finished reports
+        IntervalReport ring[RING_CAPACITY];
+        std::atomic<unsigned long> head;    // next slot to write (event loop)
+        std::atomic<unsigned long> tail;    // next slot to read (writer thread)
+        unsigned long dropped;              // reports lost because the ring was full
+        std::atomic<bool> finished;
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        std::thread writer;
+
+        void resetWindow(int windowStart);
+        void publish(const IntervalReport& report);
+        void writeReports();
+
+    public:
+        /******* Start of Interval Reporter Public Interface *******/
+
+        // Description: Constructor. Reports every simInterval units of simulated
+        //              time and/or every wallMillis milliseconds (0 disables either).
+        //              Reports are written to out by a separate thread.
+        IntervalReporter(int simInterval, int wallMillis, std::ostream& out);
+
+        // Description: Destructor
+        // Postcondition: Every published report has been written.
+        ~IntervalReporter();
+
+        // Description: Starts the first window at startTime, clearing anything
+        //              counted so far; call with the time of the first event when
+        //              the event loop starts, so that the first window neither
+        //              covers the time before it nor the loading of the trace.
+        void begin(int startTime);
+
+        // Description: Returns true if a report is due before processing an
+        //              event at currentTime.
+        // Time Efficiency: O(1)
+        bool due(int currentTime) const {
+            if (simInterval > 0 && currentTime >= nextBoundary) return true;
+            return wallInterval.count() > 0 && current.events % WALL_CHECK_EVENTS == 0
+                && std::chrono::steady_clock::now() - windowStarted >= wallInterval;
+        }
+
+        // Description: Records a processed event.
+        // Time Efficiency: O(1)
+        void recordEvent() {
+            current.events++;
+        }
+
+        // Description: Records a customer who has been served after waittime.
+        // Time Efficiency: O(1)
+        void recordDeparture(int waittime) {
+            current.served++;
+            current.totalwaittime += waittime;
+            if (waittime > current.maxwaittime) current.maxwaittime = waittime;
+        }
+
+        // Description: Closes the current window at currentTime (rounded down to
+        //              a report boundary in simulated-time mode) and publishes it.
+        // Time Efficiency: O(1)
+        void report(int currentTime, unsigned lineLength, unsigned heapSize);
+
+        // Description: Publishes the last, partial window, which includes events at endTime.
+        void finish(int endTime, unsigned lineLength, unsigned heapSize);
+
+        /******* End of Interval Reporter Public Interface *******/
+};
+
+#endif
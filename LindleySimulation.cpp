@@ -0,0 +1,146 @@
+/*
+ * LindleySimulation.cpp
+ *
+ * Description: Fast path for the single-teller FIFO Bank Simulation.
+ *              Waiting times follow the Lindley recursion
+ *                  W[n+1] = max(0, W[n] + S[n] - (A[n+1] - A[n]))
+ *              so they can be computed in one linear pass without any
+ *              PriorityQueue or Queue, and in parallel as a max-plus prefix scan.
+ *
+ * Author:
+ * Date:    November 17, 2023
+ *
+ */
+
+#include <thread>
+#include <climits>
+#include <numeric>
+#include <algorithm>
+#include "LindleySimulation.h"
+
+using std::vector;
+
+// The scan is split across threads only; within a chunk composeSteps() and
+// sumWaits() are scalar loops. They could be vectorized through the closed form
+//     W[n] = P[n] - min(0, P[1], ..., P[n]),  P[n] = x[1] + ... + x[n],
+//     x[n] = S[n-1] - (A[n] - A[n-1])
+// where the x[n] are independent and P and its running minimum are SIMD prefix
+// scans. That is left out on purpose: compilers do not vectorize prefix scans
+// on their own, and hand-written SIMD would tie this file to one instruction set.
+
+// Below this many customers per thread the scan is not worth splitting.
+static const size_t MIN_CUSTOMERS_PER_THREAD = 1 << 16;
+
+// Description: One Lindley step, or a composition of steps, in max-plus form:
+//              w -> max(floor, w + shift)
+struct LindleyStep {
+    long long floor;
+    long long shift;
+};
+
+SimulationStats::SimulationStats() :
+    peopleprocessed(0), totalwaittime(0) {
+}
+
+// Description: Returns the order in which customers arrive: by arrival time,
+//              customers arriving at the same time in input order.
+vector<size_t> arrivalOrder(const vector<int>& arrivals) {
+    vector<size_t> order(arrivals.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (!qualifiesForLindley(arrivals)) {
+        std::stable_sort(order.begin(), order.end(),
+                         [&arrivals](size_t a, size_t b) { return arrivals[a] < arrivals[b]; });
+    }
+    return order;
+}
+
+// Description: Returns true if arrival times never decrease.
+bool qualifiesForLindley(const vector<int>& arrivals) {
+    for (size_t n = 1; n < arrivals.size(); n++) {
+        if (arrivals[n] < arrivals[n - 1]) return false;
+    }
+    return true;
+}
+
+// Description: Composes the steps of customers [first, last) into a single step.
+// Time Efficiency: O(last - first)
+static LindleyStep composeSteps(const vector<int>& arrivals, const vector<int>& transactions,
+                                size_t first, size_t last) {
+    // Identity: w -> max(-infinity, w + 0)
+    LindleyStep step = {LLONG_MIN / 2, 0};
+    for (size_t n = first; n < last; n++) {
+        long long x = (long long)transactions[n - 1] - (arrivals[n] - arrivals[n - 1]);
+        step.floor = step.floor + x > 0 ? step.floor + x : 0;
+        step.shift += x;
+    }
+    return step;
+}
+
+// Description: Returns the total waiting time of customers [first, last),
+//              given the waiting time of customer first - 1.
+// Time Efficiency: O(last - first)
+static long long sumWaits(const vector<int>& arrivals, const vector<int>& transactions,
+                          size_t first, size_t last, long long wait) {
+    long long total = 0;
+    for (size_t n = first; n < last; n++) {
+        wait += (long long)transactions[n - 1] - (arrivals[n] - arrivals[n - 1]);
+        if (wait < 0) wait = 0;
+        total += wait;
+    }
+    return total;
+}
+
+// Description: Computes the statistics of the single-teller simulation with the
+//              Lindley recursion, splitting the trace across threads.
+SimulationStats simulateLindley(const vector<int>& arrivals, const vector<int>& transactions, unsigned threads) {
+    SimulationStats stats;
+    size_t count = arrivals.size();
+    stats.peopleprocessed = (int)count;
+    // The first customer never waits
+    if (count < 2) return stats;
+
+    size_t chunks = threads ? threads : 1;
+    if (chunks > (count - 1) / MIN_CUSTOMERS_PER_THREAD) chunks = (count - 1) / MIN_CUSTOMERS_PER_THREAD;
+    if (chunks == 0) chunks = 1;
+    if (chunks == 1) {
+        stats.totalwaittime = (double)sumWaits(arrivals, transactions, 1, count, 0);
+        return stats;
+    }
+
+    // Customers 1 .. count-1 are split into contiguous chunks
+    vector<size_t> bounds(chunks + 1);
+    for (size_t c = 0; c <= chunks; c++) {
+        bounds[c] = 1 + (count - 1) * c / chunks;
+    }
+
+    // Pass 1: each chunk reduces its steps to one max-plus step
+    vector<LindleyStep> steps(chunks);
+    vector<std::thread> workers;
+    for (size_t c = 1; c < chunks; c++) {
+        workers.emplace_back([&, c]() { steps[c] = composeSteps(arrivals, transactions, bounds[c], bounds[c + 1]); });
+    }
+    steps[0] = composeSteps(arrivals, transactions, bounds[0], bounds[1]);
+    for (std::thread& w : workers) w.join();
+    workers.clear();
+
+    // Exclusive scan over chunks: waiting time just before each chunk
+    vector<long long> startWait(chunks);
+    long long wait = 0;
+    for (size_t c = 0; c < chunks; c++) {
+        startWait[c] = wait;
+        wait = wait + steps[c].shift > steps[c].floor ? wait + steps[c].shift : steps[c].floor;
+    }
+
+    // Pass 2: each chunk replays its customers from its starting wait
+    vector<long long> totals(chunks);
+    for (size_t c = 1; c < chunks; c++) {
+        workers.emplace_back([&, c]() { totals[c] = sumWaits(arrivals, transactions, bounds[c], bounds[c + 1], startWait[c]); });
+    }
+    totals[0] = sumWaits(arrivals, transactions, bounds[0], bounds[1], startWait[0]);
+    for (std::thread& w : workers) w.join();
+
+    long long totalwait = 0;
+    for (long long chunkTotal : totals) totalwait += chunkTotal;
+    stats.totalwaittime = (double)totalwait;
+    return stats;
+}
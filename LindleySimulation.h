@@ -0,0 +1,47 @@
+/*
+ * LindleySimulation.h
+ *
+ * Description: Fast path for the single-teller FIFO Bank Simulation.
+ *              Waiting times follow the Lindley recursion
+ *                  W[n+1] = max(0, W[n] + S[n] - (A[n+1] - A[n]))
+ *              so they can be computed in one linear pass without any
+ *              PriorityQueue or Queue, and in parallel as a max-plus prefix scan.
+ *
+ * Author:
+ * Date:    November 17, 2023
+ *
+ */
+
+#ifndef LINDLEYSIMULATION_H
+#define LINDLEYSIMULATION_H
+
+#include <cstddef>
+#include <vector>
+
+// Description: Final statistics of a single-teller simulation.
+struct SimulationStats {
+    int peopleprocessed;
+    double totalwaittime;
+
+    SimulationStats();
+};
+
+// Description: Returns the order in which customers arrive: by arrival time,
+//              customers arriving at the same time in input order. This is the
+//              order in which every engine serves them.
+// Time Efficiency: O(n) if arrivals are sorted, otherwise O(n log2 n)
+std::vector<size_t> arrivalOrder(const std::vector<int>& arrivals);
+
+// Description: Returns true if the trace can be simulated with the Lindley recursion
+//              and give exactly the event-driven result: arrival times must not
+//              decrease, so the service order is the input order.
+// Time Efficiency: O(n)
+bool qualifiesForLindley(const std::vector<int>& arrivals);
+
+// Description: Computes the statistics of the single-teller simulation with the
+//              Lindley recursion, splitting the trace across threads.
+// Precondition: qualifiesForLindley(arrivals) and arrivals.size() == transactions.size()
+// Time Efficiency: O(n / threads + threads)
+SimulationStats simulateLindley(const std::vector<int>& arrivals, const std::vector<int>& transactions, unsigned threads);
+
+#endif
@@ -36,6 +36,14 @@ bool PriorityQueue<ElementType>::isEmpty() const {
     return binaryheap->getElementCount() == 0;
 }
 
+// Description: Returns the number of elements in this Priority Queue.
+// Postcondition: This Priority Queue is unchanged by this operation.
+// Time Efficiency: O(1)
+template <class ElementType>
+unsigned int PriorityQueue<ElementType>::getElementCount() const {
+    return binaryheap->getElementCount();
+}
+
 // Description: Inserts newElement in this Priority Queue and 
 //              returns true if successful, otherwise false.
 // Time Efficiency: O(log2 n)
@@ -34,6 +34,11 @@ class PriorityQueue {
         // Time Efficiency: O(1)
         bool isEmpty() const;
 
+        // Description: Returns the number of elements in this Priority Queue.
+        // Postcondition: This Priority Queue is unchanged by this operation.
+        // Time Efficiency: O(1)
+        unsigned int getElementCount() const;
+
         // Description: Inserts newElement in this Priority Queue and 
         //              returns true if successful, otherwise false.
         // Time Efficiency: O(log2 n)
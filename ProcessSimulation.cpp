@@ -0,0 +1,206 @@
+/*
+ * ProcessSimulation.cpp
+ *
+ * Description: Process-oriented Bank Simulation built on C++20 coroutines.
+ *              A customer is written as a sequential coroutine
+ *                  co_await bank.arrive(a);
+ *                  co_await bank.acquire(teller);
+ *                  co_await bank.hold(t);
+ *                  bank.release(teller);
+ *              and resumed by a ProcessScheduler ordered by a PriorityQueue.
+ *              Coroutine frames are drawn from a per-thread FramePool.
+ *
+ * Author:
+ * Date:    November 17, 2023
+ *
+ */
+
+#include <iostream>
+#include <exception>
+#include <new>
+#include "EmptyDataCollectionException.h"
+#include "ProcessSimulation.h"
+
+using std::cout;
+using std::vector;
+
+// Description: Constructor
+FramePool::FramePool() {
+    for (size_t c = 0; c < SIZE_CLASSES; c++) {
+        freeLists[c] = nullptr;
+    }
+}
+
+// Description: Destructor
+// Postcondition: Recycled blocks are returned to the system.
+FramePool::~FramePool() {
+    for (size_t c = 0; c < SIZE_CLASSES; c++) {
+        while (freeLists[c]) {
+            Block* next = freeLists[c]->next;
+            ::operator delete(freeLists[c]);
+            freeLists[c] = next;
+        }
+    }
+}
+
+// Description: Returns memory for a frame of size bytes.
+void* FramePool::allocate(size_t size) {
+    size_t sizeClass = (size - 1) / GRANULE;
+    if (sizeClass >= SIZE_CLASSES) return ::operator new(size);
+    Block* block = freeLists[sizeClass];
+    if (block) {
+        freeLists[sizeClass] = block->next;
+        return block;
+    }
+    return ::operator new((sizeClass + 1) * GRANULE);
+}
+
+// Description: Recycles memory returned by allocate(size).
+void FramePool::deallocate(void* frame, size_t size) {
+    size_t sizeClass = (size - 1) / GRANULE;
+    if (sizeClass >= SIZE_CLASSES) {
+        ::operator delete(frame);
+        return;
+    }
+    Block* block = static_cast<Block*>(frame);
+    block->next = freeLists[sizeClass];
+    freeLists[sizeClass] = block;
+}
+
+// Description: Pool used by coroutines created on the calling thread.
+FramePool& FramePool::local() {
+    static thread_local FramePool pool;
+    return pool;
+}
+
+void Process::promise_type::unhandled_exception() {
+    std::terminate();
+}
+
+// Description: Earlier time first; equal times in scheduling order.
+bool Wakeup::operator<=(const Wakeup& rhs) const {
+    if (time != rhs.time) return time < rhs.time;
+    return order <= rhs.order;
+}
+
+void Wakeup::print() const {
+    cout << "wakeup at " << time;
+}
+
+// Description: Constructor
+Resource::Resource() :
+    busy(false) {
+}
+
+// Description: Constructor
+ProcessScheduler::ProcessScheduler() :
+    currentTime(0), scheduled(0) {
+}
+
+// Description: Returns the current simulated time.
+int ProcessScheduler::getTime() const {
+    return currentTime;
+}
+
+void ProcessScheduler::schedule(std::coroutine_handle<> process, int time) {
+    Wakeup wakeup = {time, scheduled++, process};
+    wakeups.enqueue(wakeup);
+}
+
+// Description: Starts process immediately; it runs until its first co_await.
+void ProcessScheduler::spawn(Process process) {
+    process.handle.resume();
+}
+
+// Description: co_await arrive(time) resumes the process at the given time
+//              (immediately if that time has come).
+ProcessScheduler::TimeAwaiter ProcessScheduler::arrive(int time) {
+    return TimeAwaiter{*this, time};
+}
+
+// Description: co_await hold(duration) resumes the process duration later
+//              (immediately if duration is 0).
+ProcessScheduler::TimeAwaiter ProcessScheduler::hold(int duration) {
+    return TimeAwaiter{*this, currentTime + duration};
+}
+
+// Description: co_await acquire(resource) resumes the process once it holds resource.
+ProcessScheduler::AcquireAwaiter ProcessScheduler::acquire(Resource& resource) {
+    return AcquireAwaiter{*this, resource};
+}
+
+// A free resource is taken without suspending.
+bool ProcessScheduler::AcquireAwaiter::await_ready() noexcept {
+    if (resource.busy) return false;
+    resource.busy = true;
+    return true;
+}
+
+void ProcessScheduler::AcquireAwaiter::await_suspend(std::coroutine_handle<> process) {
+    Wakeup wakeup = {scheduler.currentTime, 0, process};
+    resource.waiting.enqueue(wakeup);
+}
+
+// Description: Releases resource; the first waiting process (if any)
+//              takes it over and is scheduled to resume at the current time.
+void ProcessScheduler::release(Resource& resource) {
+    if (resource.waiting.isEmpty()) {
+        resource.busy = false;
+        return;
+    }
+    std::coroutine_handle<> next;
+    try {next = resource.waiting.peek().process;}
+    catch (EmptyDataCollectionException& anException) {}
+    try {resource.waiting.dequeue();}
+    catch (EmptyDataCollectionException& anException) {}
+    // The resource stays busy: ownership passes straight to next.
+    // Resuming next from run() rather than here keeps the stack flat when
+    // a chain of waiters each hold the resource for no time.
+    schedule(next, currentTime);
+}
+
+// Description: Resumes processes in time order until none are left.
+void ProcessScheduler::run() {
+    while (!wakeups.isEmpty()) {
+        Wakeup wakeup;
+        try {wakeup = wakeups.peek();}
+        catch (EmptyDataCollectionException& anException) {}
+        try {wakeups.dequeue();}
+        catch (EmptyDataCollectionException& anException) {}
+        currentTime = wakeup.time;
+        wakeup.process.resume();
+    }
+}
+
+// Description: A bank customer: arrives, waits for the teller, is served, leaves.
+static Process customer(ProcessScheduler& bank, Resource& teller, int arrival, int transaction,
+                        SimulationStats& stats) {
+    co_await bank.arrive(arrival);
+    co_await bank.acquire(teller);
+    stats.totalwaittime += bank.getTime() - arrival;
+    co_await bank.hold(transaction);
+    bank.release(teller);
+    stats.peopleprocessed++;
+}
+
+// Description: Brings the customers into the bank in arrival order, so only
+//              customers currently in the bank have a frame and a wakeup.
+static Process customerSource(ProcessScheduler& bank, Resource& teller, const vector<int>& arrivals,
+                              const vector<int>& transactions, const vector<size_t>& order,
+                              SimulationStats& stats) {
+    for (size_t i : order) {
+        co_await bank.arrive(arrivals[i]);
+        bank.spawn(customer(bank, teller, arrivals[i], transactions[i], stats));
+    }
+}
+
+// Description: Single-teller simulation written as customer processes.
+SimulationStats simulateProcesses(const vector<int>& arrivals, const vector<int>& transactions) {
+    SimulationStats stats;
+    ProcessScheduler bank;
+    Resource teller;
+    vector<size_t> order = arrivalOrder(arrivals);
+    bank.spawn(customerSource(bank, teller, arrivals, transactions, order, stats));
+    bank.run();
+    return stats;
+}
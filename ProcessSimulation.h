@@ -0,0 +1,163 @@
+/*
+ * ProcessSimulation.h
+ *
+ * Description: Process-oriented Bank Simulation built on C++20 coroutines.
+ *              A customer is written as a sequential coroutine
+ *                  co_await bank.arrive(a);
+ *                  co_await bank.acquire(teller);
+ *                  co_await bank.hold(t);
+ *                  bank.release(teller);
+ *              and resumed by a ProcessScheduler ordered by a PriorityQueue.
+ *              Coroutine frames are drawn from a per-thread FramePool.
+ *
+ * Author:
+ * Date:    November 17, 2023
+ *
+ */
+
+#ifndef PROCESSSIMULATION_H
+#define PROCESSSIMULATION_H
+
+#include <coroutine>
+#include <cstddef>
+#include <vector>
+#include "Queue.h"
+#include "PriorityQueue.h"
+#include "LindleySimulation.h"
+
+// Description: Block allocator for coroutine frames.
+//              Frames are rounded up to a multiple of GRANULE bytes and recycled
+//              through one free list per size; blocks are never returned to the
+//              system until the pool is destroyed. Frames larger than
+//              GRANULE * SIZE_CLASSES bypass the pool.
+class FramePool {
+    private:
+        static const size_t GRANULE = 64;
+        static const size_t SIZE_CLASSES = 8;
+        struct Block { Block* next; };
+        Block* freeLists[SIZE_CLASSES];
+
+    public:
+        FramePool();
+        ~FramePool();
+
+        // Description: Returns memory for a frame of size bytes.
+        // Time Efficiency: O(1)
+        void* allocate(size_t size);
+
+        // Description: Recycles memory returned by allocate(size).
+        // Time Efficiency: O(1)
+        void deallocate(void* frame, size_t size);
+
+        // Description: Pool used by coroutines created on the calling thread.
+        static FramePool& local();
+};
+
+// Description: Handle to a process coroutine.
+//              A process starts suspended and is started by ProcessScheduler::spawn();
+//              its frame is released when it runs to completion.
+struct Process {
+    struct promise_type {
+        Process get_return_object() { return Process{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception();
+
+        static void* operator new(size_t size) { return FramePool::local().allocate(size); }
+        static void operator delete(void* frame, size_t size) { FramePool::local().deallocate(frame, size); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Description: A suspended process waiting to be resumed.
+//              Ordered by time, then by the order in which it was scheduled.
+struct Wakeup {
+    int time;
+    unsigned long order;
+    std::coroutine_handle<> process;
+
+    bool operator<=(const Wakeup& rhs) const;
+    void print() const;
+};
+
+// Description: A resource held by one process at a time (e.g. a teller).
+//              Waiting processes are granted it in FIFO order.
+class Resource {
+    friend class ProcessScheduler;
+    private:
+        bool busy;
+        Queue<Wakeup> waiting;
+
+    public:
+        // Description: Constructor
+        Resource();
+};
+
+class ProcessScheduler {
+    private:
+        PriorityQueue<Wakeup> wakeups;
+        int currentTime;
+        unsigned long scheduled;
+
+        void schedule(std::coroutine_handle<> process, int time);
+
+    public:
+        // Suspends the calling process until a given simulated time.
+        struct TimeAwaiter {
+            ProcessScheduler& scheduler;
+            int time;
+            bool await_ready() const noexcept { return time <= scheduler.currentTime; }
+            void await_suspend(std::coroutine_handle<> process) { scheduler.schedule(process, time); }
+            void await_resume() const noexcept {}
+        };
+
+        // Suspends the calling process until it holds a resource.
+        struct AcquireAwaiter {
+            ProcessScheduler& scheduler;
+            Resource& resource;
+            bool await_ready() noexcept;
+            void await_suspend(std::coroutine_handle<> process);
+            void await_resume() const noexcept {}
+        };
+
+        /******* Start of Process Scheduler Public Interface *******/
+
+        // Description: Constructor
+        ProcessScheduler();
+
+        // Description: Returns the current simulated time.
+        int getTime() const;
+
+        // Description: Starts process immediately; it runs until its first co_await.
+        void spawn(Process process);
+
+        // Description: co_await arrive(time) resumes the process at the given time
+        //              (immediately if that time has come).
+        TimeAwaiter arrive(int time);
+
+        // Description: co_await hold(duration) resumes the process duration later
+        //              (immediately if duration is 0).
+        TimeAwaiter hold(int duration);
+
+        // Description: co_await acquire(resource) resumes the process once it holds resource.
+        AcquireAwaiter acquire(Resource& resource);
+
+        // Description: Releases resource; the first waiting process (if any)
+        //              takes it over and is scheduled to resume at the current time.
+        void release(Resource& resource);
+
+        // Description: Resumes processes in time order until none are left.
+        // Time Efficiency: O(n log2 n), n = number of suspensions
+        void run();
+
+        /******* End of Process Scheduler Public Interface *******/
+};
+
+// Description: Single-teller simulation written as customer processes.
+// Postcondition: Same statistics as the event-driven engine; both serve customers
+//                arriving at the same time in input order.
+SimulationStats simulateProcesses(const std::vector<int>& arrivals, const std::vector<int>& transactions);
+
+#endif
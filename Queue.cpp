@@ -22,6 +22,7 @@ Queue<ElementType>::Queue() :
     capacity(INITIAL_CAPACITY), 
     frontindex(0), 
     backindex(0), 
+    shrinking(true), 
     elements(new ElementType[INITIAL_CAPACITY]) {
 }
 
@@ -43,6 +44,23 @@ bool Queue<ElementType>::isEmpty() const {
     return elementCount == 0;
 }
 
+// Description: Returns the number of elements in this Queue.
+// Postcondition: This Queue is unchanged by this operation.
+// Time Efficiency: O(1)
+template <class ElementType>
+unsigned Queue<ElementType>::getElementCount() const {
+    return elementCount;
+}
+
+// Description: Turns shrinking on dequeue() on or off (it is on by default).
+//              With shrinking off, the Queue keeps the largest capacity
+//              it has grown to, so it can be reused without reallocating.
+// Time Efficiency: O(1)
+template <class ElementType>
+void Queue<ElementType>::setShrinking(bool shrinking) {
+    this->shrinking = shrinking;
+}
+
 // Description:  Change the capacity of the array to newlen
 // Precondition:  newlen >= INITIAL_CAPACITY
 template <class ElementType>
@@ -102,7 +120,7 @@ void Queue<ElementType>::dequeue() {
     if (elementCount == 0) {
         throw EmptyDataCollectionException("dequeue() called but Queue is empty.");
     }
-    if (elementCount <= capacity / 4) {
+    if (shrinking && elementCount <= capacity / 4) {
         if (capacity / 2 >= INITIAL_CAPACITY) {
             if (!resize(capacity / 2)) {
                 // cout << "resize failed" << endl;
@@ -23,6 +23,7 @@ class Queue {
         unsigned capacity;
         unsigned frontindex;
         unsigned backindex;
+        bool shrinking;
 
         bool resize (unsigned len);
     public:
@@ -39,6 +40,17 @@ class Queue {
         // Postcondition: This Queue is unchanged by this operation.
         // Time Efficiency: O(1)
         bool isEmpty() const;
+
+        // Description: Returns the number of elements in this Queue.
+        // Postcondition: This Queue is unchanged by this operation.
+        // Time Efficiency: O(1)
+        unsigned getElementCount() const;
+
+        // Description: Turns shrinking on dequeue() on or off (it is on by default).
+        //              With shrinking off, the Queue keeps the largest capacity
+        //              it has grown to, so it can be reused without reallocating.
+        // Time Efficiency: O(1)
+        void setShrinking(bool shrinking);
         
         // Description: Inserts newElement at the "back" of this Queue 
         //              (not necessarily the "back" of this Queue's data structure) 
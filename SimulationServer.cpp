@@ -0,0 +1,324 @@
+/*
+ * SimulationServer.cpp
+ *
+ * Description: Long-running simulation service on a Unix domain socket.
+ *              A client writes "arrival transaction" lines terminated by an
+ *              empty line (or by closing its write side) and gets back one
+ *              line of JSON with the final statistics. A connection may send
+ *              any number of traces; responses come back in order. Extra
+ *              empty lines between traces are ignored.
+ *              One thread polls every connection and hands each complete
+ *              trace to a pool of worker threads, so an idle connection never
+ *              holds a worker. Each worker keeps its PriorityQueue, Queue
+ *              (with shrinking turned off) and trace arrays across requests,
+ *              so they keep the capacity they have grown to.
+ *
+ * Author:
+ * Date:    November 17, 2023
+ *
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <signal.h>
+#include "EmptyDataCollectionException.h"
+#include "SimulationServer.h"
+
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+using std::chrono::steady_clock;
+
+static const size_t READ_BUFFER_SIZE = 1 << 16;
+
+// A trace received in full, waiting for a worker.
+struct Trace {
+    string text;
+    steady_clock::time_point received;      // when its terminating empty line / EOF arrived
+};
+
+// A client connection. partial and lineLength belong to the polling thread;
+// the rest is guarded by Connection::mutex.
+struct Connection {
+    int fd;
+    string partial;             // lines of the trace being received
+    unsigned lineLength = 0;    // characters in the current line so far
+
+    std::mutex mutex;
+    std::deque<Trace> traces;   // complete traces not yet answered
+    bool scheduled = false;     // queued for, or being served by, a worker
+    bool inputClosed = false;   // the client will send no more traces
+};
+
+// Storage owned by one worker and reused for every request it serves.
+struct ServerWorker {
+    PriorityQueue<Event> eventPriorityQueue;
+    Queue<Event> bankLine;
+    vector<int> arrivals;
+    vector<int> transactions;
+
+    ServerWorker() { bankLine.setShrinking(false); }
+};
+
+// Connections with traces waiting for a worker.
+static Queue<Connection*> readyConnections;
+static std::mutex readyMutex;
+static std::condition_variable readyWake;
+
+// Description: Parses one "arrival transaction" line into the worker's trace.
+//              Malformed lines are ignored.
+static void parseLine(const char* line, ServerWorker& worker) {
+    char* end;
+    long a = strtol(line, &end, 10);
+    if (end == line) return;
+    const char* rest = end;
+    long t = strtol(rest, &end, 10);
+    if (end == rest) return;
+    worker.arrivals.push_back((int)a);
+    worker.transactions.push_back((int)t);
+}
+
+// Description: Simulates trace and writes the response to fd.
+static void respond(int fd, const Trace& trace, ServerWorker& worker, EventEngine engine) {
+    const char* line = trace.text.c_str();
+    while (*line) {
+        parseLine(line, worker);
+        const char* next = strchr(line, '\n');
+        if (!next) break;
+        line = next + 1;
+    }
+
+    SimulationStats stats;
+    if (qualifiesForLindley(worker.arrivals)) {
+        stats = simulateLindley(worker.arrivals, worker.transactions, 1);
+    } else {
+        stats = engine(worker.arrivals, worker.transactions, &worker.eventPriorityQueue, &worker.bankLine);
+    }
+    long long micros = std::chrono::duration_cast<std::chrono::microseconds>(
+        steady_clock::now() - trace.received).count();
+    worker.arrivals.clear();
+    worker.transactions.clear();
+
+    char response[160];
+    int length;
+    if (stats.peopleprocessed > 0) {
+        length = snprintf(response, sizeof(response),
+                          "{\"processed\":%d,\"totalwait\":%.17g,\"averagewait\":%.17g,\"micros\":%lld}\n",
+                          stats.peopleprocessed, stats.totalwaittime,
+                          stats.totalwaittime / stats.peopleprocessed, micros);
+    } else {
+        length = snprintf(response, sizeof(response),
+                          "{\"processed\":0,\"totalwait\":0,\"averagewait\":null,\"micros\":%lld}\n", micros);
+    }
+    // A client that has gone away just loses its response
+    send(fd, response, length, MSG_NOSIGNAL);
+}
+
+// Description: Hands a complete trace of connection to the worker pool.
+//              Traces of one connection are answered by one worker at a time,
+//              in the order they were received.
+static void submitTrace(Connection* connection, Trace& trace) {
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(connection->mutex);
+        connection->traces.push_back(std::move(trace));
+        if (!connection->scheduled) {
+            connection->scheduled = true;
+            schedule = true;
+        }
+    }
+    if (schedule) {
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            readyConnections.enqueue(connection);
+        }
+        readyWake.notify_one();
+    }
+}
+
+// Description: Marks connection as finished sending; it is closed as soon as
+//              its last trace has been answered.
+static void closeInput(Connection* connection) {
+    bool idle;
+    {
+        std::lock_guard<std::mutex> lock(connection->mutex);
+        connection->inputClosed = true;
+        idle = !connection->scheduled;
+    }
+    if (idle) {
+        close(connection->fd);
+        delete connection;
+    }
+}
+
+// Description: Worker thread: answers the pending traces of ready connections.
+static void runWorker(EventEngine engine) {
+    ServerWorker* worker = new ServerWorker();
+    while (true) {
+        Connection* connection;
+        {
+            std::unique_lock<std::mutex> lock(readyMutex);
+            readyWake.wait(lock, [] { return !readyConnections.isEmpty(); });
+            connection = readyConnections.peek();
+            readyConnections.dequeue();
+        }
+        while (true) {
+            std::unique_lock<std::mutex> lock(connection->mutex);
+            if (connection->traces.empty()) {
+                connection->scheduled = false;
+                bool finished = connection->inputClosed;
+                lock.unlock();
+                // Last response sent and the client has stopped sending
+                if (finished) {
+                    close(connection->fd);
+                    delete connection;
+                }
+                break;
+            }
+            Trace trace = std::move(connection->traces.front());
+            connection->traces.pop_front();
+            lock.unlock();
+            respond(connection->fd, trace, *worker, engine);
+        }
+    }
+}
+
+// Description: Splits received bytes into traces.
+// Postcondition: Every trace completed by an empty line is submitted. Empty
+//                lines with no trace before them are ignored, so blank lines
+//                between traces do not produce empty responses.
+static void receive(Connection* connection, const char* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        char c = data[i];
+        if (c == '\r') continue;
+        if (c != '\n') {
+            connection->partial.push_back(c);
+            connection->lineLength++;
+            continue;
+        }
+        if (connection->lineLength > 0) {
+            connection->partial.push_back('\n');
+            connection->lineLength = 0;
+            continue;
+        }
+        // Empty line: end of this trace, if there is one
+        if (connection->partial.empty()) continue;
+        Trace trace;
+        trace.text.swap(connection->partial);
+        trace.received = steady_clock::now();
+        submitTrace(connection, trace);
+    }
+}
+
+// Description: Opens a listening socket at socketPath.
+//              Returns -1 if that is not possible.
+static int listenOn(const char* socketPath) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socketPath) >= sizeof(address.sun_path)) {
+        cout << "Socket path too long: " << socketPath << endl;
+        return -1;
+    }
+    strcpy(address.sun_path, socketPath);
+
+    // Only replace a stale socket, never some other file
+    struct stat existing;
+    if (lstat(socketPath, &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            cout << socketPath << " exists and is not a socket" << endl;
+            return -1;
+        }
+        if (unlink(socketPath) < 0) {
+            perror(socketPath);
+            return -1;
+        }
+    } else if (errno != ENOENT) {
+        perror(socketPath);
+        return -1;
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        perror("socket");
+        return -1;
+    }
+    if (bind(listener, (sockaddr*)&address, sizeof(address)) < 0 || listen(listener, 128) < 0) {
+        perror(socketPath);
+        close(listener);
+        return -1;
+    }
+    return listener;
+}
+
+// Description: Listens on socketPath and serves requests on threads workers.
+bool serveSimulations(const char* socketPath, unsigned threads, EventEngine engine) {
+    int listener = listenOn(socketPath);
+    if (listener < 0) return false;
+    signal(SIGPIPE, SIG_IGN);
+
+    if (threads == 0) threads = 1;
+    for (unsigned i = 0; i < threads; i++) {
+        std::thread(runWorker, engine).detach();
+    }
+    cout << "Serving simulations on " << socketPath << " with " << threads << " workers" << endl;
+
+    // polled[0] is the listener; polled[i] belongs to connections[i]
+    vector<pollfd> polled;
+    vector<Connection*> connections;
+    polled.push_back({listener, POLLIN, 0});
+    connections.push_back(nullptr);
+    char* buffer = new char[READ_BUFFER_SIZE];
+
+    while (true) {
+        if (poll(polled.data(), polled.size(), -1) < 0) continue;
+
+        for (size_t i = polled.size() - 1; i > 0; i--) {
+            if (polled[i].revents == 0) continue;
+            Connection* connection = connections[i];
+            ssize_t received = read(connection->fd, buffer, READ_BUFFER_SIZE);
+            if (received > 0) {
+                receive(connection, buffer, received);
+                continue;
+            }
+            if (received < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+            // Client closed its write side: a trace without its empty line still counts
+            if (!connection->partial.empty()) {
+                Trace trace;
+                trace.text.swap(connection->partial);
+                trace.received = steady_clock::now();
+                submitTrace(connection, trace);
+            }
+            polled[i] = polled.back();
+            polled.pop_back();
+            connections[i] = connections.back();
+            connections.pop_back();
+            closeInput(connection);
+        }
+
+        if (polled[0].revents & POLLIN) {
+            int fd = accept(listener, nullptr, nullptr);
+            if (fd >= 0) {
+                Connection* connection = new Connection();
+                connection->fd = fd;
+                polled.push_back({fd, POLLIN, 0});
+                connections.push_back(connection);
+            }
+        }
+    }
+}
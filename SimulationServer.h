@@ -0,0 +1,46 @@
+/*
+ * SimulationServer.h
+ *
+ * Description: Long-running simulation service on a Unix domain socket.
+ *              A client writes "arrival transaction" lines terminated by an
+ *              empty line (or by closing its write side) and gets back one
+ *              line of JSON with the final statistics. A connection may send
+ *              any number of traces; responses come back in order. Extra
+ *              empty lines between traces are ignored.
+ *              One thread polls every connection and hands each complete
+ *              trace to a pool of worker threads, so an idle connection never
+ *              holds a worker. Each worker keeps its PriorityQueue, Queue
+ *              (with shrinking turned off) and trace arrays across requests,
+ *              so they keep the capacity they have grown to.
+ *
+ * Author:
+ * Date:    November 17, 2023
+ *
+ */
+
+#ifndef SIMULATIONSERVER_H
+#define SIMULATIONSERVER_H
+
+#include <vector>
+#include "Event.h"
+#include "Queue.h"
+#include "PriorityQueue.h"
+#include "LindleySimulation.h"
+
+// Description: Event-driven engine run by the server for traces that do not
+//              qualify for the Lindley fast path.
+// Precondition: eventPriorityQueue and bankLine are empty, and are left empty.
+typedef SimulationStats (*EventEngine)(const std::vector<int>& arrivals, const std::vector<int>& transactions,
+                                       PriorityQueue<Event>* eventPriorityQueue, Queue<Event>* bankLine);
+
+// Description: Listens on socketPath and serves requests on threads workers.
+//              An existing socket at socketPath is replaced; any other kind
+//              of file there is left alone and the server does not start.
+//              Only returns (false) if the socket cannot be set up.
+// Response: {"processed":n,"totalwait":w,"averagewait":a,"micros":us}
+//           where micros runs from the end of the trace (its empty line or
+//           EOF) being received to the response being ready: waiting for a
+//           worker, parsing and simulating.
+bool serveSimulations(const char* socketPath, unsigned threads, EventEngine engine);
+
+#endif
@@ -0,0 +1,50 @@
+#!/bin/sh
+#
+# check_branches.sh
+#
+# Description: Differential test of the multi-branch simulation. Runs
+#              "BankSimApp --branches n --threads k" against
+#              "BankSimApp --branches n --sequential" for several thread
+#              counts, balk lengths and walk times, and compares the
+#              statistics (everything after the "Simulation Begins" line).
+#
+# Usage: tests/check_branches.sh [path/to/BankSimApp]
+#
+
+BANKSIM=${1:-./BankSimApp}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+failed=0
+for branches in 1 3 8; do
+    # Busy trace with a branch column, so lines build up and customers walk,
+    # and the same kind of trace without one (round-robin assignment).
+    awk -v branches=$branches 'BEGIN { srand(26); t = 0; for (i = 0; i < 50000; i++) { t += int(rand() * 3); print t, 1 + int(rand() * 10), int(rand() * branches) } }' > "$WORK/assigned.txt"
+    awk 'BEGIN { srand(126); t = 0; for (i = 0; i < 50000; i++) { t += int(rand() * 2); print t, 1 + int(rand() * 10) } }' > "$WORK/round_robin.txt"
+    for trace in "$WORK/assigned.txt" "$WORK/round_robin.txt"; do
+        for balk in 0 3; do
+            for walk in 1 5; do
+                options="--branches $branches --balk $balk --walk $walk"
+                if ! "$BANKSIM" $options --sequential < "$trace" > "$WORK/out.txt"; then
+                    echo "FAIL $(basename "$trace") $options --sequential"
+                    cat "$WORK/out.txt"
+                    failed=1
+                    continue
+                fi
+                tail -n +2 "$WORK/out.txt" > "$WORK/sequential.txt"
+                for threads in 1 2 4 7; do
+                    if "$BANKSIM" $options --threads $threads < "$trace" > "$WORK/out.txt" \
+                       && tail -n +2 "$WORK/out.txt" > "$WORK/parallel.txt" \
+                       && cmp -s "$WORK/sequential.txt" "$WORK/parallel.txt"; then
+                        echo "PASS $(basename "$trace") $options --threads $threads"
+                    else
+                        echo "FAIL $(basename "$trace") $options --threads $threads"
+                        diff "$WORK/sequential.txt" "$WORK/parallel.txt" | head -20
+                        failed=1
+                    fi
+                done
+            done
+        done
+    done
+done
+exit $failed
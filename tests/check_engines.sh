@@ -0,0 +1,43 @@
+#!/bin/sh
+#
+# check_engines.sh
+#
+# Description: Differential test of the single-teller engines. Runs
+#              "BankSimApp --check" (event engine vs coroutine process engine
+#              vs Lindley fast path, when the trace qualifies) on every trace
+#              in tests/traces and on a few generated ones, with one and with
+#              several threads.
+#
+# Usage: tests/check_engines.sh [path/to/BankSimApp]
+#
+
+BANKSIM=${1:-./BankSimApp}
+DIR=$(dirname "$0")
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# Deep queue of zero-length transactions: one long customer, then 1000000
+# customers with transaction time 0 who all queue behind it.
+awk 'BEGIN { print 0, 2000000; for (i = 1; i <= 1000000; i++) print i, 0 }' > "$WORK/deep_queue.txt"
+
+# Large random trace near full load, long enough to be split across threads.
+awk 'BEGIN { srand(27); t = 0; for (i = 0; i < 300000; i++) { t += 1 + int(rand() * 6); print t, 1 + int(rand() * 6) } }' > "$WORK/random.txt"
+
+# Unsorted trace in which many customers arrive at the same time, so the
+# fast path is skipped and ties are served in input order.
+awk 'BEGIN { srand(29); for (i = 0; i < 200000; i++) print int(rand() * 1000000), int(rand() * 7) }' > "$WORK/shuffled_ties.txt"
+
+failed=0
+for trace in "$DIR"/traces/*.txt "$WORK/deep_queue.txt" "$WORK/random.txt" "$WORK/shuffled_ties.txt"; do
+    for threads in 1 4; do
+        if "$BANKSIM" --check --threads $threads < "$trace" > "$WORK/out.txt" \
+           && grep -q "All engines match" "$WORK/out.txt"; then
+            echo "PASS $(basename "$trace") (threads $threads)"
+        else
+            echo "FAIL $(basename "$trace") (threads $threads)"
+            cat "$WORK/out.txt"
+            failed=1
+        fi
+    done
+done
+exit $failed